@@ -0,0 +1,352 @@
+/*
+  ==============================================================================
+
+    AnalogStages.cpp
+    Аналоговые модели дисторшна с памятью.
+
+  ==============================================================================
+*/
+
+#include "AnalogStages.h"
+
+//==============================================================================
+// Диодный клиппер
+void DiodeClipper::prepare(double sampleRate, int numChannels)
+{
+    const double period = 1.0 / sampleRate;
+
+    inputCoeff = period / (resistance * capacitance);
+    sinhCoeff = 2.0 * period * saturationCurrent / capacitance;
+
+    // Нормировка выхода по установившемуся напряжению на диодах
+    // при максимальном входе: v + 2 * R * Is * sinh(v / Vt) = vin
+    const double maxVoltage = solve(maxInputVoltage, 1.0, 2.0 * resistance * saturationCurrent, 0.0, 64);
+    outputGain = (float)(1.0 / maxVoltage);
+
+    // p = v[n-1] + k * vin, где |v| не больше maxVoltage
+    const double pMax = maxVoltage + inputCoeff * maxInputVoltage;
+    tableStart = (float)-pMax;
+    tableEnd = (float)pMax;
+    tableScale = (float)((tableSize - 1) / (2.0 * pMax));
+
+    // Заполняем таблицу, начиная каждый шаг с решения в соседнем узле
+    table.resize(tableSize);
+    double v = solve(-pMax, 1.0 + inputCoeff, sinhCoeff, 0.0, 64);
+    for (int i = 0; i < tableSize; ++i)
+    {
+        const double p = -pMax + 2.0 * pMax * i / (tableSize - 1);
+        v = solve(p, 1.0 + inputCoeff, sinhCoeff, v, 64);
+        table[(size_t)i] = (float)v;
+    }
+
+    capacitorVoltage.assign((size_t)juce::jmax(1, numChannels), 0.0f);
+}
+
+void DiodeClipper::reset()
+{
+    std::fill(capacitorVoltage.begin(), capacitorVoltage.end(), 0.0f);
+}
+
+float DiodeClipper::processSample(float input, int channel) noexcept
+{
+    jassert(channel < (int)capacitorVoltage.size());
+
+    float& v = capacitorVoltage[(size_t)channel];
+    const float p = v + (float)inputCoeff * input;
+
+    if (p > tableStart && p < tableEnd)
+    {
+        // Быстрый путь: линейная интерполяция по таблице
+        const float position = (p - tableStart) * tableScale;
+        const int index = juce::jmin((int)position, tableSize - 2);
+        const float frac = position - (float)index;
+        v = table[(size_t)index] + frac * (table[(size_t)index + 1] - table[(size_t)index]);
+    }
+    else
+    {
+        // Вход выше 0 dBFS: Ньютон от предыдущего значения
+        v = (float)solve(p, 1.0 + inputCoeff, sinhCoeff, v, fallbackIterations);
+    }
+
+    return v * outputGain;
+}
+
+double DiodeClipper::solve(double p, double a, double c, double guess, int maxIterations) noexcept
+{
+    // Функция нечётная - решаем для |p| и восстанавливаем знак
+    const double sign = p < 0.0 ? -1.0 : 1.0;
+    const double target = std::abs(p);
+
+    // Корень лежит между 0 и минимумом из линейной и диодной оценок
+    double low = 0.0;
+    double high = juce::jmin(target / a, thermalVoltage * std::asinh(target / c));
+    double v = juce::jlimit(low, high, guess * sign);
+
+    for (int i = 0; i < maxIterations; ++i)
+    {
+        const double x = v / thermalVoltage;
+        const double f = a * v + c * std::sinh(x) - target;
+
+        if (f > 0.0)
+            high = v;
+        else
+            low = v;
+
+        const double derivative = a + c / thermalVoltage * std::cosh(x);
+        double next = v - f / derivative;
+
+        // Шаг Ньютона вышел за границы - делим интервал пополам
+        if (next <= low || next >= high)
+            next = 0.5 * (low + high);
+
+        if (std::abs(next - v) < 1.0e-9)
+            return sign * next;
+
+        v = next;
+    }
+
+    return sign * v;
+}
+
+//==============================================================================
+// Триодный каскад
+void TriodeStage::prepare(double sampleRate, int numChannels)
+{
+    // Таблица не зависит от частоты дискретизации - строим один раз
+    if (table.empty())
+        buildTable();
+
+    cathodeCoeff = (float)(1.0 / (sampleRate * cathodeCapacitance));
+    dcBlockerCoeff = (float)std::exp(-2.0 * juce::MathConstants<double>::pi * 10.0 / sampleRate);
+
+    // Рабочая точка без сигнала: интегрируем катод до установления
+    float vk = 0.0f;
+    const int settleSamples = (int)(sampleRate * 0.5);
+    for (int i = 0; i < settleSamples; ++i)
+    {
+        const float vpk = lookupPlate(-vk, vk);
+        const float ip = (float)((supplyVoltage - vk - vpk) / plateResistance);
+        vk += cathodeCoeff * (ip - vk / (float)cathodeResistance);
+    }
+
+    quiescentCathode = vk;
+    quiescentPlate = vk + lookupPlate(-vk, vk);
+
+    // Отсечка: ток анода падает ниже 1% от тока покоя
+    const double quiescentCurrent = quiescentCathode / cathodeResistance;
+    double cutoffGrid = gridMin;
+    for (int g = gridPoints - 1; g >= 0; --g)
+    {
+        const double vgk = gridVoltage(g);
+        const double vpk = lookupPlate((float)vgk, quiescentCathode);
+        if (plateCurrent(vgk, vpk) < 0.01 * quiescentCurrent)
+        {
+            cutoffGrid = vgk;
+            break;
+        }
+    }
+
+    // Пороги в единицах входа: vg = vgk + vk. Смещение рабочей точки
+    // под сигналом не учитывается
+    linearRange = { quiescentCathode + (float)cutoffGrid, quiescentCathode + positiveGridLimit };
+
+    states.resize((size_t)juce::jmax(1, numChannels));
+    calibrateOutput(sampleRate);
+    reset();
+}
+
+void TriodeStage::calibrateOutput(double sampleRate)
+{
+    // Выход несимметричен (отсечка и насыщение на разных уровнях), поэтому
+    // нормируем по измеренному пику после разделительного конденсатора
+    // на синусе максимального уровня: выход до 0 dBFS остаётся в [-1, 1]
+    outputGain = 1.0f;
+    reset();
+
+    const int settleSamples = (int)(sampleRate * 0.25);
+    const int measureSamples = (int)(sampleRate * 0.25);
+    const double phaseStep = 2.0 * juce::MathConstants<double>::pi * 100.0 / sampleRate;
+    float peak = 0.0f;
+
+    for (int i = 0; i < settleSamples + measureSamples; ++i)
+    {
+        const float output = processSample(maxInputVoltage * (float)std::sin(phaseStep * i), 0);
+        if (i >= settleSamples)
+            peak = juce::jmax(peak, std::abs(output));
+    }
+
+    outputGain = peak > 0.0f ? 1.0f / peak : 1.0f;
+}
+
+void TriodeStage::reset()
+{
+    for (auto& state : states)
+    {
+        state.cathodeVoltage = quiescentCathode;
+        state.plateVoltage = quiescentPlate - quiescentCathode;
+        state.dcBlockerInput = 0.0f;
+        state.dcBlockerOutput = 0.0f;
+    }
+}
+
+float TriodeStage::processSample(float input, int channel) noexcept
+{
+    jassert(channel < (int)states.size());
+
+    auto& state = states[(size_t)channel];
+    const float vk = state.cathodeVoltage;
+
+    // Вход трактуем как напряжение на сетке в вольтах
+    const float vgk = input - vk;
+    float vpk;
+
+    if (vgk >= gridMin && vgk <= gridMax)
+    {
+        // Вход до 0 dBFS: билинейная интерполяция по таблице
+        vpk = lookupPlate(vgk, vk);
+    }
+    else
+    {
+        // Вход выше 0 dBFS: Ньютон от предыдущего значения
+        vpk = (float)solvePlate(vgk, vk, state.plateVoltage, fallbackIterations);
+    }
+
+    state.plateVoltage = vpk;
+    const float ip = (float)((supplyVoltage - vk - vpk) / plateResistance);
+
+    // Катодная RC-цепь: Ck * dvk/dt = Ip - vk / Rk
+    state.cathodeVoltage = juce::jlimit(0.0f, cathodeMax,
+        vk + cathodeCoeff * (ip - vk / (float)cathodeResistance));
+
+    // Каскад инвертирует фазу - возвращаем её обратно
+    const float processed = (quiescentPlate - (vpk + vk)) * outputGain;
+
+    // Разделительный конденсатор убирает смещение рабочей точки
+    const float output = processed - state.dcBlockerInput + dcBlockerCoeff * state.dcBlockerOutput;
+    state.dcBlockerInput = processed;
+    state.dcBlockerOutput = output;
+
+    return output;
+}
+
+double TriodeStage::plateCurrent(double vgk, double vpk) noexcept
+{
+    // Модель Корена для 12AX7
+    constexpr double mu = 100.0;
+    constexpr double ex = 1.4;
+    constexpr double kg1 = 1060.0;
+    constexpr double kp = 600.0;
+    constexpr double kvb = 300.0;
+
+    if (vpk <= 0.0)
+        return 0.0;
+
+    const double x = kp * (1.0 / mu + vgk / std::sqrt(kvb + vpk * vpk));
+    const double softplus = x > 30.0 ? x : std::log1p(std::exp(x));
+    const double e1 = vpk / kp * softplus;
+
+    return e1 > 0.0 ? 2.0 * std::pow(e1, ex) / kg1 : 0.0;
+}
+
+double TriodeStage::solvePlate(double vgk, double vk, double guess, int maxIterations) noexcept
+{
+    // (B - vk - vpk) / Ra - Ip(vgk, vpk) убывает по vpk,
+    // корень лежит в [0, B - vk]
+    double low = 0.0;
+    double high = supplyVoltage - vk;
+    double vpk = juce::jlimit(low, high, guess);
+
+    auto residual = [vgk, vk](double v) {
+        return (supplyVoltage - vk - v) / plateResistance - plateCurrent(vgk, v);
+    };
+
+    for (int i = 0; i < maxIterations; ++i)
+    {
+        const double f = residual(vpk);
+
+        if (f > 0.0)
+            low = vpk;
+        else
+            high = vpk;
+
+        // Производная по конечной разности
+        constexpr double h = 1.0e-4;
+        const double derivative = (residual(vpk + h) - f) / h;
+        double next = derivative < 0.0 ? vpk - f / derivative : 0.5 * (low + high);
+
+        if (next <= low || next >= high)
+            next = 0.5 * (low + high);
+
+        if (std::abs(next - vpk) < 1.0e-7)
+            return next;
+
+        vpk = next;
+    }
+
+    return vpk;
+}
+
+void TriodeStage::buildTable()
+{
+    table.resize((size_t)(gridPoints * cathodePoints));
+
+    for (int k = 0; k < cathodePoints; ++k)
+    {
+        const double vk = cathodeMax * k / (cathodePoints - 1);
+
+        // Тёплый старт: при запертой лампе vpk = B - vk
+        double vpk = supplyVoltage - vk;
+
+        for (int g = 0; g < gridPoints; ++g)
+        {
+            vpk = solvePlate(gridVoltage(g), vk, vpk, 64);
+            table[(size_t)(k * gridPoints + g)] = (float)vpk;
+        }
+    }
+}
+
+double TriodeStage::gridVoltage(int index) noexcept
+{
+    if (index <= lowSegments)
+        return gridMin + (double)(gridBendLow - gridMin) * index / lowSegments;
+
+    index -= lowSegments;
+    if (index <= bendSegments)
+        return gridBendLow + (double)(gridBendHigh - gridBendLow) * index / bendSegments;
+
+    index -= bendSegments;
+    return gridBendHigh + (double)(gridMax - gridBendHigh) * index / highSegments;
+}
+
+float TriodeStage::gridPosition(float vgk) noexcept
+{
+    vgk = juce::jlimit(gridMin, gridMax, vgk);
+
+    if (vgk < gridBendLow)
+        return (vgk - gridMin) * ((float)lowSegments / (gridBendLow - gridMin));
+
+    if (vgk < gridBendHigh)
+        return (float)lowSegments + (vgk - gridBendLow) * ((float)bendSegments / (gridBendHigh - gridBendLow));
+
+    return (float)(lowSegments + bendSegments) + (vgk - gridBendHigh) * ((float)highSegments / (gridMax - gridBendHigh));
+}
+
+float TriodeStage::lookupPlate(float vgk, float vk) const noexcept
+{
+    const float gridOffset = gridPosition(vgk);
+    const float cathodePosition = juce::jlimit(0.0f, cathodeMax, vk)
+        * ((float)(cathodePoints - 1) / cathodeMax);
+
+    const int g = juce::jmin((int)gridOffset, gridPoints - 2);
+    const int k = juce::jmin((int)cathodePosition, cathodePoints - 2);
+    const float gf = gridOffset - (float)g;
+    const float kf = cathodePosition - (float)k;
+
+    const float* row0 = table.data() + k * gridPoints + g;
+    const float* row1 = row0 + gridPoints;
+
+    const float v0 = row0[0] + gf * (row0[1] - row0[0]);
+    const float v1 = row1[0] + gf * (row1[1] - row1[0]);
+
+    return v0 + kf * (v1 - v0);
+}
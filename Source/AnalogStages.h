@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+    AnalogStages.h
+    Аналоговые модели дисторшна с памятью: диодный клиппер (RC-цепь)
+    и триодный каскад с общим катодом.
+
+    Нелинейные уравнения решаются заранее в prepareToPlay и сохраняются
+    в таблицы, поэтому внутри таблиц каждый сэмпл стоит фиксированное
+    число операций без итераций. За их пределами работает Ньютон
+    с ограниченным числом итераций и тёплым стартом.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+//==============================================================================
+/**
+    Диодный клиппер: последовательный резистор R и конденсатор C,
+    параллельно которому включены два встречных диода.
+
+        C * dv/dt = (vin - v) / R - 2 * Is * sinh(v / Vt)
+
+    Дискретизация обратным методом Эйлера сводит шаг к уравнению
+    v * (1 + k) + c * sinh(v / Vt) = p, где p = v[n-1] + k * vin[n].
+    Решение v(p) одномерное, поэтому хранится в таблице по p.
+*/
+class DiodeClipper
+{
+public:
+    // Пересчитывает таблицу решателя под текущую частоту дискретизации
+    void prepare(double sampleRate, int numChannels);
+    void reset();
+
+    // Вход - сигнал после Gain и Drive, выход нормирован примерно к [-1, 1]
+    float processSample(float input, int channel) noexcept;
+
+private:
+    // Ньютон с защитой бисекцией для v * a + c * sinh(v / Vt) = p
+    static double solve(double p, double a, double c, double guess, int maxIterations) noexcept;
+
+    // Параметры цепи (1N4148, срез RC около 7 кГц)
+    static constexpr double resistance = 2.2e3;
+    static constexpr double capacitance = 10.0e-9;
+    static constexpr double saturationCurrent = 2.52e-9;
+    static constexpr double thermalVoltage = 25.85e-3 * 1.752; // Vt с учётом коэффициента идеальности
+
+    // Максимальный вход для таблицы: 5x Gain * 10x Drive при сигнале 0 dBFS
+    static constexpr float maxInputVoltage = 50.0f;
+    static constexpr int tableSize = 4096;
+    static constexpr int fallbackIterations = 8;
+
+    double inputCoeff = 0.0;   // k = T / (R * C)
+    double sinhCoeff = 0.0;    // c = 2 * T * Is / C
+    float outputGain = 1.0f;
+
+    std::vector<float> table;  // v(p) на равномерной сетке
+    float tableStart = 0.0f;
+    float tableEnd = 0.0f;
+    float tableScale = 0.0f;   // узлов на единицу p
+
+    std::vector<float> capacitorVoltage; // состояние по каналам
+};
+
+//==============================================================================
+/**
+    Триодный каскад (12AX7, модель Корена) с анодной нагрузкой Ra
+    и катодной цепью Rk || Ck.
+
+    Для заданных напряжений сетка-катод и катода анодное напряжение
+    находится из (B - vk - vpk) / Ra = Ip(vgk, vpk). Решение двумерное
+    и хранится в таблице по (vgk, vk) с билинейной интерполяцией,
+    а напряжение катода интегрируется как состояние. Таблица покрывает
+    вход до 0 dBFS; выше уравнение решается Ньютоном от предыдущего vpk.
+*/
+class TriodeStage
+{
+public:
+    void prepare(double sampleRate, int numChannels);
+    void reset();
+
+    float processSample(float input, int channel) noexcept;
+
+    // Диапазон входа в рабочей точке, где лампа не заперта
+    // и сетка не уходит в положительную область
+    juce::Range<float> getLinearRange() const noexcept { return linearRange; }
+
+private:
+    struct ChannelState
+    {
+        float cathodeVoltage = 0.0f;
+        float plateVoltage = 0.0f;   // vpk предыдущего сэмпла для тёплого старта
+        float dcBlockerInput = 0.0f;
+        float dcBlockerOutput = 0.0f;
+    };
+
+    static double plateCurrent(double vgk, double vpk) noexcept;
+    static double solvePlate(double vgk, double vk, double guess, int maxIterations) noexcept;
+
+    void buildTable();
+    float lookupPlate(float vgk, float vk) const noexcept;
+    void calibrateOutput(double sampleRate);
+
+    // Напряжение узла сетки и дробная позиция vgk на неравномерной оси
+    static double gridVoltage(int index) noexcept;
+    static float gridPosition(float vgk) noexcept;
+
+    // Параметры каскада
+    static constexpr double supplyVoltage = 250.0;
+    static constexpr double plateResistance = 100.0e3;
+    static constexpr double cathodeResistance = 1.5e3;
+    static constexpr double cathodeCapacitance = 22.0e-6;
+
+    // Максимальный вход: 5x Gain * 10x Drive при сигнале 0 dBFS
+    static constexpr float maxInputVoltage = 50.0f;
+    static constexpr int fallbackIterations = 8;
+
+    // Ось vgk покрывает весь вход до 0 dBFS при любом vk и состоит
+    // из трёх равномерных участков: плотный там, где характеристика
+    // изгибается (отсечка и переход к положительной сетке), и редкие
+    // по краям, где она почти линейна
+    static constexpr float cathodeMax = 6.0f;
+    static constexpr float gridMin = -maxInputVoltage - cathodeMax;
+    static constexpr float gridBendLow = -6.0f;
+    static constexpr float gridBendHigh = 2.0f;
+    static constexpr float gridMax = maxInputVoltage;
+    static constexpr int lowSegments = 50;
+    static constexpr int bendSegments = 256;
+    static constexpr int highSegments = 96;
+    static constexpr int gridPoints = lowSegments + bendSegments + highSegments + 1;
+    static constexpr int cathodePoints = 25;
+
+    // Выше этого vgk сетка уходит в положительную область - считаем клиппингом
+    static constexpr float positiveGridLimit = 1.0f;
+
+    std::vector<float> table; // vpk[cathode][grid]
+
+    float cathodeCoeff = 0.0f;    // T / Ck
+    float dcBlockerCoeff = 0.0f;
+    float quiescentCathode = 0.0f;
+    float quiescentPlate = 0.0f;
+    float outputGain = 1.0f;
+    juce::Range<float> linearRange;
+
+    std::vector<ChannelState> states;
+};
@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+    DspTelemetry.cpp
+    Статистика обработки для офлайн-анализа.
+
+  ==============================================================================
+*/
+
+#include "DspTelemetry.h"
+
+namespace
+{
+    // Атомарный максимум для float
+    void updateMaximum(std::atomic<float>& target, float value) noexcept
+    {
+        float current = target.load(std::memory_order_relaxed);
+        while (value > current
+               && ! target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // Атомарное сложение для double (fetch_add для double есть только с C++20)
+    void addAtomic(std::atomic<double>& target, double value) noexcept
+    {
+        double current = target.load(std::memory_order_relaxed);
+        while (! target.compare_exchange_weak(current, current + value, std::memory_order_relaxed))
+        {
+        }
+    }
+}
+
+//==============================================================================
+void DspTelemetry::Block::addInput(const float* data, int count) noexcept
+{
+    if (count <= 0)
+        return;
+
+    // Пик через векторные операции JUCE
+    const auto range = juce::FloatVectorOperations::findMinAndMax(data, count);
+    const float peak = juce::jmax(-range.getStart(), range.getEnd()) * drivenScale;
+    peakDrivenInput = juce::jmax(peakDrivenInput, peak);
+
+    // Безветвлённый счётчик, компилятор разворачивает его в SIMD
+    const float low = linearRange.getStart();
+    const float high = linearRange.getEnd();
+
+    int clipped = 0;
+    for (int i = 0; i < count; ++i)
+        clipped += (data[i] < low) | (data[i] > high);
+
+    clippedSamples += clipped;
+    numSamples += count;
+}
+
+void DspTelemetry::Block::addOutput(const float* data, int count) noexcept
+{
+    if (count <= 0)
+        return;
+
+    const auto range = juce::FloatVectorOperations::findMinAndMax(data, count);
+    peakOutput = juce::jmax(peakOutput, -range.getStart(), range.getEnd());
+
+    // Четыре независимые суммы, чтобы цикл векторизовался без -ffast-math
+    float sums[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        for (int lane = 0; lane < 4; ++lane)
+            sums[lane] += data[i + lane] * data[i + lane];
+
+    for (; i < count; ++i)
+        sums[0] += data[i] * data[i];
+
+    outputSumSquares += (double)sums[0] + sums[1] + sums[2] + sums[3];
+    outputSamples += count;
+}
+
+//==============================================================================
+void DspTelemetry::reset() noexcept
+{
+    for (int type = 0; type < maxTypes; ++type)
+    {
+        numSamples[(size_t)type].store(0, std::memory_order_relaxed);
+        clippedSamples[(size_t)type].store(0, std::memory_order_relaxed);
+    }
+
+    peakDrivenInput.store(0.0f, std::memory_order_relaxed);
+    peakOutput.store(0.0f, std::memory_order_relaxed);
+    outputSumSquares.store(0.0, std::memory_order_relaxed);
+    outputSamples.store(0, std::memory_order_relaxed);
+}
+
+void DspTelemetry::merge(const Block& block, int type) noexcept
+{
+    jassert(juce::isPositiveAndBelow(type, maxTypes));
+
+    if (! juce::isPositiveAndBelow(type, maxTypes))
+        return;
+
+    numSamples[(size_t)type].fetch_add(block.numSamples, std::memory_order_relaxed);
+    clippedSamples[(size_t)type].fetch_add(block.clippedSamples, std::memory_order_relaxed);
+
+    updateMaximum(peakDrivenInput, block.peakDrivenInput);
+    updateMaximum(peakOutput, block.peakOutput);
+
+    // reset() может прийти из другого потока, поэтому сложение через CAS
+    addAtomic(outputSumSquares, block.outputSumSquares);
+    outputSamples.fetch_add(block.outputSamples, std::memory_order_relaxed);
+}
+
+DspTelemetry::Snapshot DspTelemetry::getSnapshot() const noexcept
+{
+    Snapshot snapshot;
+
+    for (int type = 0; type < maxTypes; ++type)
+    {
+        snapshot.numSamples[(size_t)type] = numSamples[(size_t)type].load(std::memory_order_relaxed);
+        snapshot.clippedSamples[(size_t)type] = clippedSamples[(size_t)type].load(std::memory_order_relaxed);
+    }
+
+    snapshot.peakDrivenInput = peakDrivenInput.load(std::memory_order_relaxed);
+    snapshot.peakOutput = peakOutput.load(std::memory_order_relaxed);
+    snapshot.outputSumSquares = outputSumSquares.load(std::memory_order_relaxed);
+    snapshot.outputSamples = outputSamples.load(std::memory_order_relaxed);
+
+    return snapshot;
+}
+
+//==============================================================================
+double DspTelemetry::Snapshot::getClipRate(int type) const
+{
+    const auto total = numSamples[(size_t)type];
+    return total > 0 ? (double)clippedSamples[(size_t)type] / (double)total : 0.0;
+}
+
+double DspTelemetry::Snapshot::getCrestFactor() const
+{
+    if (outputSamples == 0 || outputSumSquares <= 0.0)
+        return 0.0;
+
+    const double rms = std::sqrt(outputSumSquares / (double)outputSamples);
+    return peakOutput / rms;
+}
+
+juce::String DspTelemetry::Snapshot::toJson(const juce::StringArray& typeNames) const
+{
+    juce::Array<juce::var> types;
+
+    for (int type = 0; type < juce::jmin(typeNames.size(), maxTypes); ++type)
+    {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("type", typeNames[type]);
+        entry->setProperty("samples", numSamples[(size_t)type]);
+        entry->setProperty("clippedSamples", clippedSamples[(size_t)type]);
+        entry->setProperty("clipRate", getClipRate(type));
+        types.add(juce::var(entry));
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("types", types);
+    root->setProperty("peakDrivenInput", peakDrivenInput);
+    root->setProperty("peakOutput", peakOutput);
+    root->setProperty("outputCrestFactor", getCrestFactor());
+
+    return juce::JSON::toString(juce::var(root));
+}
+
+juce::String DspTelemetry::Snapshot::toCsv(const juce::StringArray& typeNames) const
+{
+    // Общие показатели повторяются в каждой строке, чтобы файл читался как одна таблица
+    juce::String csv = "type,samples,clipped_samples,clip_rate,peak_driven_input,peak_output,output_crest_factor\n";
+
+    for (int type = 0; type < juce::jmin(typeNames.size(), maxTypes); ++type)
+    {
+        csv << typeNames[type] << ","
+            << juce::String(numSamples[(size_t)type]) << ","
+            << juce::String(clippedSamples[(size_t)type]) << ","
+            << juce::String(getClipRate(type), 6) << ","
+            << juce::String(peakDrivenInput, 6) << ","
+            << juce::String(peakOutput, 6) << ","
+            << juce::String(getCrestFactor(), 6) << "\n";
+    }
+
+    return csv;
+}
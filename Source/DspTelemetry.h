@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    DspTelemetry.h
+    Статистика обработки для офлайн-анализа: доля сэмплов в зоне
+    клиппинга по типам дисторшна, пик входа после Gain и Drive,
+    пик-фактор выхода.
+
+    Аудио-поток собирает данные блока в локальный Block и сливает
+    их в атомарные счётчики один раз за блок, без блокировок.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+//==============================================================================
+class DspTelemetry
+{
+public:
+    static constexpr int maxTypes = 8;
+
+    // Накопитель одного блока, живёт на стеке processBlock
+    struct Block
+    {
+        // linearRange - зона без клиппинга в единицах входа (до Gain и Drive)
+        Block(float scale, juce::Range<float> range) noexcept
+            : drivenScale(scale), linearRange(range) {}
+
+        // Вход кривой блоком (Dual Mono) или по одному сэмплу (Linked, Mid/Side)
+        void addInput(const float* data, int numSamples) noexcept;
+        void addSample(float input) noexcept
+        {
+            peakDrivenInput = juce::jmax(peakDrivenInput, std::abs(input) * drivenScale);
+            clippedSamples += (input < linearRange.getStart()) | (input > linearRange.getEnd());
+            ++numSamples;
+        }
+
+        void addOutput(const float* data, int numSamples) noexcept;
+
+        float drivenScale;
+        juce::Range<float> linearRange;
+
+        juce::int64 numSamples = 0;
+        juce::int64 clippedSamples = 0;
+        float peakDrivenInput = 0.0f;
+        float peakOutput = 0.0f;
+        double outputSumSquares = 0.0;
+        juce::int64 outputSamples = 0;
+    };
+
+    // Снимок накопленной статистики для чтения вне аудио-потока
+    struct Snapshot
+    {
+        std::array<juce::int64, maxTypes> numSamples {};
+        std::array<juce::int64, maxTypes> clippedSamples {};
+        float peakDrivenInput = 0.0f;
+        float peakOutput = 0.0f;
+        double outputSumSquares = 0.0;
+        juce::int64 outputSamples = 0;
+
+        double getClipRate(int type) const;
+        double getCrestFactor() const;
+
+        juce::String toJson(const juce::StringArray& typeNames) const;
+        juce::String toCsv(const juce::StringArray& typeNames) const;
+    };
+
+    DspTelemetry() { reset(); }
+
+    void setEnabled(bool shouldBeEnabled) noexcept { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+    void reset() noexcept;
+    void merge(const Block& block, int type) noexcept;
+
+    Snapshot getSnapshot() const noexcept;
+
+private:
+    std::atomic<bool> enabled { false };
+
+    std::array<std::atomic<juce::int64>, maxTypes> numSamples {};
+    std::array<std::atomic<juce::int64>, maxTypes> clippedSamples {};
+    std::atomic<float> peakDrivenInput { 0.0f };
+    std::atomic<float> peakOutput { 0.0f };
+    std::atomic<double> outputSumSquares { 0.0 };
+    std::atomic<juce::int64> outputSamples { 0 };
+};
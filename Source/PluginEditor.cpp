@@ -48,6 +48,7 @@ BeastDistortionAudioProcessorEditor::BeastDistortionAudioProcessorEditor (BeastD
     setupSlider(gainSlider, gainValueLabel, 50.0);
     setupSlider(distortionSlider, distortionValueLabel, 50.0);
     setupSlider(outputSlider, outputValueLabel, 50.0);
+    setupSlider(mixSlider, mixValueLabel, 100.0);
 
     // === НАСТРОЙКА ЛЕЙБЛОВ СЛАЙДЕРОВ ===
 
@@ -62,6 +63,7 @@ BeastDistortionAudioProcessorEditor::BeastDistortionAudioProcessorEditor (BeastD
     setupSliderLabel(gainLabel, "GAIN");
     setupSliderLabel(distortionLabel, "DISTORTION");
     setupSliderLabel(outputLabel, "OUTPUT");
+    setupSliderLabel(mixLabel, "MIX");
 
     // === НАСТРОЙКА ВЫБОРА ТИПА ДИСТОРШНА ===
 
@@ -69,6 +71,8 @@ BeastDistortionAudioProcessorEditor::BeastDistortionAudioProcessorEditor (BeastD
     typeComboBox.addItem("SOFT CLIP", 2);
     typeComboBox.addItem("OVERDRIVE", 3);
     typeComboBox.addItem("FOLDBACK", 4);
+    typeComboBox.addItem("DIODE", 5);
+    typeComboBox.addItem("TRIODE", 6);
     typeComboBox.setSelectedId(1);
     typeComboBox.addListener(this);
     typeComboBox.setColour(juce::ComboBox::backgroundColourId, juce::Colour(70, 70, 70));
@@ -82,6 +86,24 @@ BeastDistortionAudioProcessorEditor::BeastDistortionAudioProcessorEditor (BeastD
     typeLabel.setFont(juce::Font(16.0f, juce::Font::bold));
     addAndMakeVisible(typeLabel);
 
+    // === НАСТРОЙКА СТЕРЕО-РЕЖИМА ===
+
+    stereoComboBox.addItem("DUAL MONO", 1);
+    stereoComboBox.addItem("LINKED", 2);
+    stereoComboBox.addItem("MID/SIDE", 3);
+    stereoComboBox.setSelectedId(1);
+    stereoComboBox.addListener(this);
+    stereoComboBox.setColour(juce::ComboBox::backgroundColourId, juce::Colour(70, 70, 70));
+    stereoComboBox.setColour(juce::ComboBox::textColourId, textColour);
+    stereoComboBox.setColour(juce::ComboBox::arrowColourId, sliderColour);
+    addAndMakeVisible(stereoComboBox);
+
+    stereoLabel.setText("MODE:", juce::dontSendNotification);
+    stereoLabel.setJustificationType(juce::Justification::centredLeft);
+    stereoLabel.setColour(juce::Label::textColourId, textColour);
+    stereoLabel.setFont(juce::Font(16.0f, juce::Font::bold));
+    addAndMakeVisible(stereoLabel);
+
     // === НАСТРОЙКА ПРЕСЕТОВ ===
 
     presetComboBox.addItem("DEFAULT", 1);
@@ -145,9 +167,9 @@ void BeastDistortionAudioProcessorEditor::resized()
     auto sliderArea = area.removeFromTop(350); // Высота области со слайдерами
     sliderArea.removeFromTop(80); // Отступаем от заголовка
 
-    // Распределяем пространство для 3 слайдеров
-    auto sliderWidth = sliderArea.getWidth() / 3;
-    int sliderSize = 180; // Размер слайдера (диаметр)
+    // Распределяем пространство для 4 слайдеров
+    auto sliderWidth = sliderArea.getWidth() / 4;
+    int sliderSize = 170; // Размер слайдера (диаметр)
     int labelHeight = 30;
     int valueLabelHeight = 40;
 
@@ -172,7 +194,7 @@ void BeastDistortionAudioProcessorEditor::resized()
         .withHeight(labelHeight));
 
     // OUTPUT SLIDER
-    auto outputArea = sliderArea;
+    auto outputArea = sliderArea.removeFromLeft(sliderWidth);
     outputSlider.setBounds(outputArea.withSizeKeepingCentre(sliderSize, sliderSize));
     // Значение внутри слайдера
     outputValueLabel.setBounds(outputArea.withSizeKeepingCentre(60, valueLabelHeight)
@@ -181,19 +203,34 @@ void BeastDistortionAudioProcessorEditor::resized()
     outputLabel.setBounds(outputArea.withTrimmedTop(sliderSize + 10)
         .withHeight(labelHeight));
 
+    // MIX SLIDER
+    auto mixArea = sliderArea;
+    mixSlider.setBounds(mixArea.withSizeKeepingCentre(sliderSize, sliderSize));
+    // Значение внутри слайдера
+    mixValueLabel.setBounds(mixArea.withSizeKeepingCentre(60, valueLabelHeight)
+        .withY(mixSlider.getBounds().getCentreY() - valueLabelHeight / 2));
+    // Подпись под слайдером
+    mixLabel.setBounds(mixArea.withTrimmedTop(sliderSize + 10)
+        .withHeight(labelHeight));
+
     // === НИЖНЯЯ ПАНЕЛЬ КОНТРОЛЕВ ===
     auto controlArea = area.reduced(20);
     controlArea.removeFromTop(20); // Отступ сверху
 
-    // Верхний ряд: TYPE и PRESET
+    // Верхний ряд: TYPE, MODE и PRESET
     auto topRow = controlArea.removeFromTop(40);
-    auto controlWidth = topRow.getWidth() / 2;
+    auto controlWidth = topRow.getWidth() / 3;
 
     // TYPE
     auto typeArea = topRow.removeFromLeft(controlWidth).reduced(5);
     typeLabel.setBounds(typeArea.removeFromLeft(60));
     typeComboBox.setBounds(typeArea.reduced(5, 0));
 
+    // MODE
+    auto stereoArea = topRow.removeFromLeft(controlWidth).reduced(5);
+    stereoLabel.setBounds(stereoArea.removeFromLeft(60));
+    stereoComboBox.setBounds(stereoArea.reduced(5, 0));
+
     // PRESET
     auto presetArea = topRow.reduced(5);
     presetLabel.setBounds(presetArea.removeFromLeft(60));
@@ -228,6 +265,12 @@ void BeastDistortionAudioProcessorEditor::sliderValueChanged(juce::Slider* slide
         audioProcessor.getOutputParam()->setValueNotifyingHost(outputSlider.getValue() / 100.0f);
         outputValueLabel.setText(juce::String(outputSlider.getValue(), 0), juce::dontSendNotification);
     }
+    else if (slider == &mixSlider)
+    {
+        // используем getMixParam()
+        audioProcessor.getMixParam()->setValueNotifyingHost(mixSlider.getValue() / 100.0f);
+        mixValueLabel.setText(juce::String(mixSlider.getValue(), 0), juce::dontSendNotification);
+    }
 }
 
 void BeastDistortionAudioProcessorEditor::comboBoxChanged(juce::ComboBox* comboBox)
@@ -235,7 +278,22 @@ void BeastDistortionAudioProcessorEditor::comboBoxChanged(juce::ComboBox* comboB
     if (comboBox == &typeComboBox)
     {
         // используем getTypeParam() 
-        audioProcessor.getTypeParam()->setValueNotifyingHost((typeComboBox.getSelectedId() - 1) / 3.0f);
+        auto* typeParam = audioProcessor.getTypeParam();
+        typeParam->setValueNotifyingHost(typeParam->convertTo0to1((float)(typeComboBox.getSelectedId() - 1)));
+
+        // LINKED недоступен для DIODE и TRIODE: у моделей с памятью
+        // процессор обрабатывает каналы как Dual Mono
+        const bool linkedAvailable = typeComboBox.getSelectedId() <= 4;
+        stereoComboBox.setItemEnabled(2, linkedAvailable);
+
+        if (! linkedAvailable && stereoComboBox.getSelectedId() == 2)
+            stereoComboBox.setSelectedId(1);
+    }
+    else if (comboBox == &stereoComboBox)
+    {
+        // используем getStereoModeParam()
+        auto* stereoModeParam = audioProcessor.getStereoModeParam();
+        stereoModeParam->setValueNotifyingHost(stereoModeParam->convertTo0to1((float)(stereoComboBox.getSelectedId() - 1)));
     }
 }
 
@@ -247,7 +305,9 @@ void BeastDistortionAudioProcessorEditor::buttonClicked(juce::Button* button)
         gainSlider.setValue(50.0);
         distortionSlider.setValue(50.0);
         outputSlider.setValue(50.0);
+        mixSlider.setValue(100.0);
         typeComboBox.setSelectedId(1);
+        stereoComboBox.setSelectedId(1);
         bypassButton.setToggleState(false, juce::sendNotification);
     }
     else if (button == &bypassButton)
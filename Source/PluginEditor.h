@@ -40,21 +40,28 @@ private:
     juce::Slider gainSlider;
     juce::Slider distortionSlider;
     juce::Slider outputSlider;
+    juce::Slider mixSlider;
 
     // Лейблы для слайдеров
     juce::Label gainLabel;
     juce::Label distortionLabel;
     juce::Label outputLabel;
+    juce::Label mixLabel;
 
     // Лейблы значений слайдеров
     juce::Label gainValueLabel;
     juce::Label distortionValueLabel;
     juce::Label outputValueLabel;
+    juce::Label mixValueLabel;
 
     // Выбор типа дисторшна
     juce::ComboBox typeComboBox;
     juce::Label typeLabel;
 
+    // Выбор стерео-режима
+    juce::ComboBox stereoComboBox;
+    juce::Label stereoLabel;
+
     // Кнопки
     juce::TextButton resetButton;
     juce::TextButton bypassButton;
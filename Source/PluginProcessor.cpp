@@ -9,6 +9,49 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+namespace
+{
+    using FloatRegister = juce::dsp::SIMDRegister<float>;
+
+    // Кривые без памяти для целого регистра, те же формулы, что в processSample
+    FloatRegister hardClip(FloatRegister x) noexcept
+    {
+        return FloatRegister::max(FloatRegister::expand(-1.0f),
+                                  FloatRegister::min(FloatRegister::expand(1.0f), x));
+    }
+
+    FloatRegister softClip(FloatRegister x) noexcept
+    {
+        // Векторного tanh в JUCE нет - считаем по дорожкам, точность как у скалярной версии
+        for (size_t lane = 0; lane < FloatRegister::size(); ++lane)
+            x.set(lane, std::tanh(x.get(lane)));
+        return x;
+    }
+
+    FloatRegister overdrive(FloatRegister x) noexcept
+    {
+        const auto one = FloatRegister::expand(1.0f);
+        const auto above = FloatRegister::greaterThan(x, one);
+        const auto below = FloatRegister::lessThan(x, FloatRegister::expand(-1.0f));
+
+        // exp(-|x|) не переполняется и годится для обеих ветвей
+        auto decay = FloatRegister::abs(x);
+        for (size_t lane = 0; lane < FloatRegister::size(); ++lane)
+            decay.set(lane, std::exp(-decay.get(lane)));
+
+        return (x & ~(above | below)) + ((one - decay) & above) + ((decay - one) & below);
+    }
+
+    FloatRegister foldback(FloatRegister x) noexcept
+    {
+        // x > 1: 2 - x, x < -1: -2 - x, без ветвлений
+        const auto zero = FloatRegister::expand(0.0f);
+        const auto one = FloatRegister::expand(1.0f);
+        return x - FloatRegister::max(x - one, zero) * 2.0f
+                 + FloatRegister::max(zero - x - one, zero) * 2.0f;
+    }
+}
+
 //==============================================================================
 BeastDistortionAudioProcessor::BeastDistortionAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -61,6 +104,8 @@ BeastDistortionAudioProcessor::BeastDistortionAudioProcessor()
     distortionTypes.add("Soft Clip");
     distortionTypes.add("Overdrive");
     distortionTypes.add("Foldback");
+    distortionTypes.add("Diode Clipper");
+    distortionTypes.add("Triode");
 
     // Инициализация параметра выбора типа дисторшна
     addParameter(typeParam = new juce::AudioParameterChoice(
@@ -77,6 +122,34 @@ BeastDistortionAudioProcessor::BeastDistortionAudioProcessor()
         false  // По умолчанию выключен
     ));
 
+    // Инициализация параметра Mix (100 - только обработанный сигнал)
+    addParameter(mixParam = new juce::AudioParameterFloat(
+        "mix",
+        "Mix",
+        juce::NormalisableRange<float>(0.0f, 100.0f),
+        100.0f,
+        "Mix",
+        juce::AudioProcessorParameter::genericParameter,
+        [](float value, int) { return juce::String(value, 1); }
+    ));
+
+    // Инициализация параметра стерео-режима.
+    // Linked работает только для кривых без памяти: у Diode Clipper и Triode
+    // знак key меняется при смене громкого канала и скачок попадал бы
+    // в состояние модели, поэтому для них Linked обрабатывается как Dual Mono
+    // (в редакторе пункт LINKED для этих типов недоступен)
+    juce::StringArray stereoModes;
+    stereoModes.add("Dual Mono");
+    stereoModes.add("Linked");
+    stereoModes.add("Mid/Side");
+
+    addParameter(stereoModeParam = new juce::AudioParameterChoice(
+        "stereoMode",
+        "Stereo Mode",
+        stereoModes,
+        0  // Каналы обрабатываются независимо, как раньше
+    ));
+
 }
 
 BeastDistortionAudioProcessor::~BeastDistortionAudioProcessor()
@@ -84,23 +157,29 @@ BeastDistortionAudioProcessor::~BeastDistortionAudioProcessor()
 }
 
 //==============================================================================
+// Чтение параметров один раз за блок
+void BeastDistortionAudioProcessor::updateShaperSettings()
+{
+    // Преобразуем значения параметров в рабочие диапазоны
+    shaper.gainFactor = 1.0f + (gainParam->get() / 100.0f) * 4.0f;    // 1.0x - 5.0x усиление входа
+    shaper.driveGain = 1.0f + (driveParam->get() / 100.0f) * 9.0f;    // 1.0x - 10.0x усиление дисторшна
+    shaper.outputGain = outputParam->get() / 100.0f * 2.0f;           // 0.0 - 2.0 выходное усиление
+    shaper.distortionType = typeParam->getIndex();
+    shaper.bypass = bypassParam->get();
+}
+
 // Обработка одного сэмпла
 float BeastDistortionAudioProcessor::processSample(float input, int channel)
 {
     // Если bypass включен - пропускаем сигнал без изменений
-    if (bypassParam->get())
+    if (shaper.bypass)
         return input;
 
-    // Получаем текущие значения параметров
-    float gain = gainParam->get();
-    float drive = driveParam->get();
-    float output = outputParam->get();
-    int distortionType = typeParam->getIndex();
-
-    // Преобразуем значения параметров в рабочие диапазоны
-    float gainFactor = 1.0f + (gain / 100.0f) * 4.0f;   // 1.0x - 5.0x усиление входа
-    float driveGain = 1.0f + (drive / 100.0f) * 9.0f;   // 1.0x - 10.0x усиление дисторшна
-    float outputGain = output / 100.0f * 2.0f;          // 0.0 - 2.0 выходное усиление
+    // Параметры считаны один раз за блок в updateShaperSettings()
+    const float gainFactor = shaper.gainFactor;
+    const float driveGain = shaper.driveGain;
+    const float outputGain = shaper.outputGain;
+    const int distortionType = shaper.distortionType;
 
     //  Применяем входное усиление (Gain)
     float processed = input * gainFactor;
@@ -133,6 +212,14 @@ float BeastDistortionAudioProcessor::processSample(float input, int channel)
             processed = -1.0f - (processed + 1.0f);
         break;
 
+    case 4: // Diode Clipper (RC-цепь со встречными диодами)
+        processed = diodeClipper.processSample(processed, channel);
+        break;
+
+    case 5: // Triode (каскад с общим катодом)
+        processed = triodeStage.processSample(processed, channel);
+        break;
+
     default:
         processed = juce::jlimit(-1.0f, 1.0f, processed);
         break;
@@ -142,6 +229,273 @@ float BeastDistortionAudioProcessor::processSample(float input, int channel)
     return processed * outputGain;
 }
 
+// Обработка стерео-пары
+void BeastDistortionAudioProcessor::processStereoSample(float& left, float& right, int stereoMode,
+                                                        DspTelemetry::Block* telemetryBlock)
+{
+    // Статистику входа собираем по сигналу, который реально попадает в кривую
+    auto shape = [this, telemetryBlock](float input, int channel) {
+        if (telemetryBlock != nullptr)
+            telemetryBlock->addSample(input);
+        return processSample(input, channel);
+    };
+
+    switch (stereoMode)
+    {
+    case 1: // Linked: кривая по громкому каналу, тот же коэффициент на оба
+    {
+        const float key = std::abs(left) >= std::abs(right) ? left : right;
+        const float shaped = shape(key, 0);
+
+        if (key == 0.0f)
+        {
+            left = right = shaped;
+        }
+        else
+        {
+            // Громкий канал получает ровно shaped, тихий - тот же коэффициент
+            const float ratio = shaped / key;
+            left *= ratio;
+            right *= ratio;
+        }
+        break;
+    }
+
+    case 2: // Mid/Side: кодирование и декодирование в том же проходе
+    {
+        const float mid = shape(0.5f * (left + right), 0);
+        const float side = shape(0.5f * (left - right), 1);
+        left = mid + side;
+        right = mid - side;
+        break;
+    }
+
+    default: // Dual Mono
+        left = shape(left, 0);
+        right = shape(right, 1);
+        break;
+    }
+}
+
+void BeastDistortionAudioProcessor::processStereoPair(juce::AudioBuffer<float>& buffer, float mix, int stereoMode,
+                                                      DspTelemetry::Block* telemetryBlock)
+{
+    // Режим выбираем до цикла, кривая передаётся как функция регистра
+    auto runSimd = [&](auto shape) {
+        switch (stereoMode)
+        {
+        case 1:  processStereoPairSimd<1>(buffer, mix, telemetryBlock, shape); break;
+        case 2:  processStereoPairSimd<2>(buffer, mix, telemetryBlock, shape); break;
+        default: processStereoPairSimd<0>(buffer, mix, telemetryBlock, shape); break;
+        }
+    };
+
+    switch (shaper.distortionType)
+    {
+    case 0:  runSimd(hardClip);  break;
+    case 1:  runSimd(softClip);  break;
+    case 2:  runSimd(overdrive); break;
+    case 3:  runSimd(foldback);  break;
+    default: processStereoPairScalar(buffer, mix, stereoMode, telemetryBlock); break;
+    }
+}
+
+template <int stereoMode, typename ShapeFunction>
+void BeastDistortionAudioProcessor::processStereoPairSimd(juce::AudioBuffer<float>& buffer, float mix,
+                                                          DspTelemetry::Block* telemetryBlock, ShapeFunction shape)
+{
+    constexpr int width = (int)FloatRegister::size();
+
+    const int numSamples = buffer.getNumSamples();
+    const float drivenScale = shaper.gainFactor * shaper.driveGain;
+    const float outputGain = shaper.outputGain;
+    const bool blend = mix < 1.0f;
+
+    auto* leftData = buffer.getWritePointer(0);
+    auto* rightData = buffer.getWritePointer(1);
+    auto* leftDelay = dryDelayBuffer.getWritePointer(0);
+    auto* rightDelay = dryDelayBuffer.getWritePointer(1);
+    int leftPosition = dryDelayPosition;
+    int rightPosition = dryDelayPosition;
+
+    // Выровненные рабочие массивы на стеке: канал может быть не выровнен,
+    // а хвост блока добивается нулями до ширины регистра
+    alignas(FloatRegister) float left[width];
+    alignas(FloatRegister) float right[width];
+    alignas(FloatRegister) float dryLeft[width];
+    alignas(FloatRegister) float dryRight[width];
+    alignas(FloatRegister) float curveInput[width];
+
+    for (int start = 0; start < numSamples; start += width)
+    {
+        const int count = juce::jmin(width, numSamples - start);
+
+        for (int lane = 0; lane < width; ++lane)
+        {
+            const bool inBlock = lane < count;
+            left[lane] = inBlock ? leftData[start + lane] : 0.0f;
+            right[lane] = inBlock ? rightData[start + lane] : 0.0f;
+            dryLeft[lane] = left[lane];
+            dryRight[lane] = right[lane];
+
+            if (inBlock && dryDelayLength > 1)
+            {
+                dryLeft[lane] = pushDrySample(leftDelay, leftPosition, left[lane]);
+                dryRight[lane] = pushDrySample(rightDelay, rightPosition, right[lane]);
+            }
+        }
+
+        const auto l = FloatRegister::fromRawArray(left);
+        const auto r = FloatRegister::fromRawArray(right);
+        FloatRegister wetLeft, wetRight;
+
+        if constexpr (stereoMode == 1)
+        {
+            // Linked: кривая по громкому каналу, тот же коэффициент на оба
+            const auto key = (l & FloatRegister::greaterThanOrEqual(FloatRegister::abs(l), FloatRegister::abs(r)))
+                           + (r & FloatRegister::lessThan(FloatRegister::abs(l), FloatRegister::abs(r)));
+
+            if (telemetryBlock != nullptr)
+            {
+                key.copyToRawArray(curveInput);
+                telemetryBlock->addInput(curveInput, count);
+            }
+
+            const auto shaped = shape(key * drivenScale) * outputGain;
+
+            // Деления в SIMDRegister нет - коэффициент считаем по дорожкам;
+            // при key == 0 оба канала нулевые и получают shaped напрямую
+            auto ratio = FloatRegister::expand(0.0f);
+            for (size_t lane = 0; lane < FloatRegister::size(); ++lane)
+                if (key.get(lane) != 0.0f)
+                    ratio.set(lane, shaped.get(lane) / key.get(lane));
+
+            const auto silent = shaped & FloatRegister::equal(key, FloatRegister::expand(0.0f));
+            wetLeft = l * ratio + silent;
+            wetRight = r * ratio + silent;
+        }
+        else if constexpr (stereoMode == 2)
+        {
+            // Mid/Side: кодирование, кривая и декодирование в одном проходе
+            const auto mid = (l + r) * 0.5f;
+            const auto side = (l - r) * 0.5f;
+
+            if (telemetryBlock != nullptr)
+            {
+                mid.copyToRawArray(curveInput);
+                telemetryBlock->addInput(curveInput, count);
+                side.copyToRawArray(curveInput);
+                telemetryBlock->addInput(curveInput, count);
+            }
+
+            const auto shapedMid = shape(mid * drivenScale) * outputGain;
+            const auto shapedSide = shape(side * drivenScale) * outputGain;
+            wetLeft = shapedMid + shapedSide;
+            wetRight = shapedMid - shapedSide;
+        }
+        else
+        {
+            // Dual Mono: обе дорожки через кривую независимо
+            if (telemetryBlock != nullptr)
+            {
+                telemetryBlock->addInput(left, count);
+                telemetryBlock->addInput(right, count);
+            }
+
+            wetLeft = shape(l * drivenScale) * outputGain;
+            wetRight = shape(r * drivenScale) * outputGain;
+        }
+
+        if (blend)
+        {
+            const auto dl = FloatRegister::fromRawArray(dryLeft);
+            const auto dr = FloatRegister::fromRawArray(dryRight);
+            wetLeft = dl + (wetLeft - dl) * mix;
+            wetRight = dr + (wetRight - dr) * mix;
+        }
+
+        wetLeft.copyToRawArray(left);
+        wetRight.copyToRawArray(right);
+
+        for (int lane = 0; lane < count; ++lane)
+        {
+            leftData[start + lane] = left[lane];
+            rightData[start + lane] = right[lane];
+        }
+    }
+}
+
+void BeastDistortionAudioProcessor::processStereoPairScalar(juce::AudioBuffer<float>& buffer, float mix, int stereoMode,
+                                                            DspTelemetry::Block* telemetryBlock)
+{
+    // Linked для моделей с памятью (Diode Clipper, Triode) работает как Dual Mono,
+    // см. описание параметра stereoMode. Сюда он может прийти из автоматизации хоста
+    if (stereoMode == 1 && shaper.distortionType >= 4)
+        stereoMode = 0;
+
+    auto* leftData = buffer.getWritePointer(0);
+    auto* rightData = buffer.getWritePointer(1);
+    auto* leftDelay = dryDelayBuffer.getWritePointer(0);
+    auto* rightDelay = dryDelayBuffer.getWritePointer(1);
+    int leftPosition = dryDelayPosition;
+    int rightPosition = dryDelayPosition;
+
+    for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+    {
+        float left = leftData[sample];
+        float right = rightData[sample];
+
+        if (mix >= 1.0f)
+        {
+            if (dryDelayLength > 1)
+            {
+                pushDrySample(leftDelay, leftPosition, left);
+                pushDrySample(rightDelay, rightPosition, right);
+            }
+
+            processStereoSample(left, right, stereoMode, telemetryBlock);
+        }
+        else
+        {
+            const float dryLeft = pushDrySample(leftDelay, leftPosition, left);
+            const float dryRight = pushDrySample(rightDelay, rightPosition, right);
+
+            processStereoSample(left, right, stereoMode, telemetryBlock);
+            left = dryLeft + mix * (left - dryLeft);
+            right = dryRight + mix * (right - dryRight);
+        }
+
+        leftData[sample] = left;
+        rightData[sample] = right;
+    }
+}
+
+juce::Range<float> BeastDistortionAudioProcessor::getLinearRange(int distortionType) const
+{
+    switch (distortionType)
+    {
+    case 4: // Diode Clipper - диоды заметно открываются около 0.5 В
+        return { -0.5f, 0.5f };
+
+    case 5: // Triode - от отсечки до положительной сетки в рабочей точке
+        return triodeStage.getLinearRange();
+
+    default: // Остальные кривые начинают ограничивать с 1.0
+        return { -1.0f, 1.0f };
+    }
+}
+
+bool BeastDistortionAudioProcessor::writeTelemetry(const juce::File& file) const
+{
+    const auto snapshot = telemetry.getSnapshot();
+    const auto& typeNames = typeParam->choices;
+
+    const auto text = file.hasFileExtension("csv") ? snapshot.toCsv(typeNames)
+                                                   : snapshot.toJson(typeNames);
+
+    return file.replaceWithText(text);
+}
+
 //==============================================================================
 const juce::String BeastDistortionAudioProcessor::getName() const
 {
@@ -207,8 +561,29 @@ void BeastDistortionAudioProcessor::changeProgramName (int index, const juce::St
 //==============================================================================
 void BeastDistortionAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
+    // Пересчитываем таблицы нелинейных решателей под текущую частоту
+    // и сбрасываем состояние аналоговых моделей
+    const int numChannels = getTotalNumInputChannels();
+    diodeClipper.prepare(sampleRate, numChannels);
+    triodeStage.prepare(sampleRate, numChannels);
+
+    // Сухой сигнал задерживаем ровно на заявленную латентность,
+    // чтобы при смешивании фазы совпадали
+    dryDelayLength = getLatencySamples() + 1;
+    dryDelayBuffer.setSize(juce::jmax(1, numChannels), dryDelayLength);
+    dryDelayBuffer.clear();
+    dryDelayPosition = 0;
+}
+
+// Сброс состояния без повторного prepareToPlay (переход транспорта, офлайн-рендер)
+void BeastDistortionAudioProcessor::reset()
+{
+    diodeClipper.reset();
+    triodeStage.reset();
+
+    dryDelayBuffer.clear();
+    dryDelayPosition = 0;
+    curveWasActive = true;
 }
 
 void BeastDistortionAudioProcessor::releaseResources()
@@ -264,16 +639,100 @@ void BeastDistortionAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     // the samples and the outer loop is handling the channels.
     // Alternatively, you can process the samples with the channels
     // interleaved by keeping the same state.
-    for (int channel = 0; channel < totalNumInputChannels; ++channel)
+    const int numSamples = buffer.getNumSamples();
+    const float mix = mixParam->get() / 100.0f;
+
+    updateShaperSettings();
+
+    // При Mix 0% и Bypass кривая не работает и состояние моделей замирает.
+    // Когда она снова включается, стартуем из рабочей точки, а не из
+    // устаревшего состояния, иначе на выходе будет скачок
+    const bool curveActive = mix > 0.0f && ! shaper.bypass;
+    if (curveActive && ! curveWasActive)
+    {
+        diodeClipper.reset();
+        triodeStage.reset();
+    }
+    curveWasActive = curveActive;
+
+    // Статистика собирается только когда кривая реально работает
+    const bool collectTelemetry = telemetry.isEnabled() && curveActive;
+    const int distortionType = shaper.distortionType;
+
+    // Суммарное усиление до кривой, как в processSample
+    const float drivenScale = shaper.gainFactor * shaper.driveGain;
+    const auto drivenRange = getLinearRange(distortionType);
+    DspTelemetry::Block telemetryBlock(drivenScale, { drivenRange.getStart() / drivenScale,
+                                                      drivenRange.getEnd() / drivenScale });
+
+    jassert(dryDelayLength == getLatencySamples() + 1);
+
+    // Стерео обрабатывается одним проходом по обоим каналам: Linked и
+    // Mid/Side всегда, Dual Mono - для кривых без памяти (через SIMD).
+    // При Mix 0% кривая не работает и режим не важен
+    const int stereoMode = stereoModeParam->getIndex();
+    const bool processAsPair = totalNumInputChannels == 2 && curveActive
+                            && (stereoMode != 0 || distortionType < 4);
+
+    if (processAsPair)
+    {
+        // Вход кривой (L/R, key или mid/side) учитывается внутри прохода
+        processStereoPair(buffer, mix, stereoMode, collectTelemetry ? &telemetryBlock : nullptr);
+    }
+    else
     {
-        auto* channelData = buffer.getWritePointer (channel);
+        if (collectTelemetry)
+            for (int channel = 0; channel < totalNumInputChannels; ++channel)
+                telemetryBlock.addInput(buffer.getReadPointer (channel), numSamples);
 
-        // Обрабатываем каждый сэмпл в канале
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+        for (int channel = 0; channel < totalNumInputChannels; ++channel)
         {
-            channelData[sample] = processSample(channelData[sample], channel);
+            auto* channelData = buffer.getWritePointer (channel);
+            auto* delayData = dryDelayBuffer.getWritePointer (channel);
+            int position = dryDelayPosition;
+
+            if (mix <= 0.0f)
+            {
+                // Только сухой сигнал: без латентности буфер уже готов
+                if (dryDelayLength > 1)
+                    for (int sample = 0; sample < numSamples; ++sample)
+                        channelData[sample] = pushDrySample(delayData, position, channelData[sample]);
+            }
+            else if (mix >= 1.0f)
+            {
+                // Только обработанный сигнал: смешивание пропускаем,
+                // линию задержки продолжаем заполнять, если она есть
+                for (int sample = 0; sample < numSamples; ++sample)
+                {
+                    if (dryDelayLength > 1)
+                        pushDrySample(delayData, position, channelData[sample]);
+
+                    channelData[sample] = processSample(channelData[sample], channel);
+                }
+            }
+            else
+            {
+                // Обрабатываем каждый сэмпл и смешиваем с задержанным сухим
+                for (int sample = 0; sample < numSamples; ++sample)
+                {
+                    const float input = channelData[sample];
+                    const float dry = pushDrySample(delayData, position, input);
+                    const float wet = processSample(input, channel);
+                    channelData[sample] = dry + mix * (wet - dry);
+                }
+            }
         }
     }
+
+    if (collectTelemetry)
+        for (int channel = 0; channel < totalNumInputChannels; ++channel)
+            telemetryBlock.addOutput(buffer.getReadPointer (channel), numSamples);
+
+    dryDelayPosition = (dryDelayPosition + numSamples) % dryDelayLength;
+
+    // Один атомарный merge на блок
+    if (collectTelemetry)
+        telemetry.merge(telemetryBlock, distortionType);
 }
 
 //==============================================================================
@@ -9,6 +9,8 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "AnalogStages.h"
+#include "DspTelemetry.h"
 
 //==============================================================================
 /**
@@ -26,6 +28,8 @@ public:
     float getOutput() const { return outputParam->get(); };
     int getDistortionType() const { return typeParam->getIndex(); };
     bool getBypass() const { return bypassParam->get(); };
+    float getMix() const { return mixParam->get(); };
+    int getStereoMode() const { return stereoModeParam->getIndex(); };
 
     // Публичные методы для доступа к параметрам
     juce::AudioParameterFloat* getGainParam() const { return gainParam; }
@@ -33,10 +37,18 @@ public:
     juce::AudioParameterFloat* getOutputParam() const { return outputParam; }
     juce::AudioParameterChoice* getTypeParam() const { return typeParam; }
     juce::AudioParameterBool* getBypassParam() const { return bypassParam; }
+    juce::AudioParameterFloat* getMixParam() const { return mixParam; }
+    juce::AudioParameterChoice* getStereoModeParam() const { return stereoModeParam; }
+
+    // Статистика обработки для офлайн-рендера (по умолчанию выключена)
+    DspTelemetry& getTelemetry() { return telemetry; }
+    // Пишет накопленную статистику в .csv или .json по расширению файла
+    bool writeTelemetry(const juce::File& file) const;
 
     //==============================================================================
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
+    void reset() override;
 
    #ifndef JucePlugin_PreferredChannelConfigurations
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
@@ -75,10 +87,63 @@ private:
     juce::AudioParameterFloat* outputParam; // Выходной уровень сигнала (0-100)
     juce::AudioParameterChoice* typeParam; // Тип обработки дисторшна
     juce::AudioParameterBool* bypassParam; // вкл/выкл обработку
+    juce::AudioParameterFloat* mixParam; // Баланс сухого и обработанного сигнала (0-100)
+    juce::AudioParameterChoice* stereoModeParam; // Dual Mono / Linked / Mid/Side (Linked - только типы 0-3)
+
+    // Линия задержки сухого сигнала на латентность плагина
+    juce::AudioBuffer<float> dryDelayBuffer;
+    int dryDelayLength = 1;   // латентность + 1
+    int dryDelayPosition = 0;
+    bool curveWasActive = true; // кривая работала в прошлом блоке (Mix > 0, без Bypass)
+
+    DspTelemetry telemetry;
+
+    // Зона без клиппинга/фолдинга для типа, в единицах сигнала после Gain и Drive
+    juce::Range<float> getLinearRange(int distortionType) const;
+
+    // Аналоговые модели с памятью (таблицы решателя строятся в prepareToPlay)
+    DiodeClipper diodeClipper;
+    TriodeStage triodeStage;
+
+    // Параметры обработки, считанные один раз за блок
+    struct ShaperSettings
+    {
+        float gainFactor = 1.0f;   // 1.0x - 5.0x
+        float driveGain = 1.0f;    // 1.0x - 10.0x
+        float outputGain = 1.0f;   // 0.0 - 2.0
+        int distortionType = 0;
+        bool bypass = false;
+    };
+
+    ShaperSettings shaper;
+    void updateShaperSettings();
 
     //функция обработки одного сэмпла
     float processSample(float input, int channel);
 
+    // Обработка пары L/R в режимах Linked и Mid/Side (на месте)
+    void processStereoSample(float& left, float& right, int stereoMode, DspTelemetry::Block* telemetryBlock);
+
+    // Один проход по обоим каналам с задержкой сухого сигнала и смешиванием:
+    // кривые без памяти идут через SIMD, Diode Clipper и Triode - по сэмплам
+    void processStereoPair(juce::AudioBuffer<float>& buffer, float mix, int stereoMode, DspTelemetry::Block* telemetryBlock);
+    void processStereoPairScalar(juce::AudioBuffer<float>& buffer, float mix, int stereoMode, DspTelemetry::Block* telemetryBlock);
+
+    // L и R обрабатываются в одном проходе регистрами SIMDRegister;
+    // режим и кривая выбираются до цикла через параметры шаблона
+    template <int stereoMode, typename ShapeFunction>
+    void processStereoPairSimd(juce::AudioBuffer<float>& buffer, float mix, DspTelemetry::Block* telemetryBlock,
+                               ShapeFunction shape);
+
+    // Записывает сэмпл в линию задержки и возвращает задержанный сухой сигнал
+    float pushDrySample(float* delayData, int& position, float input) const noexcept
+    {
+        delayData[position] = input;
+        if (++position == dryDelayLength)
+            position = 0;
+        return delayData[position];
+    }
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BeastDistortionAudioProcessor)
 };